@@ -24,6 +24,30 @@
  * --------------------------------------------------------------------------------
  *
  * Update Log:
+ *        Oct 17 2026 agent: Added getMountDigest and getTableDigest.
+ *        Oct 17 2026 agent: makeUriRecord canonicalizes file server names.
+ *        Oct 17 2026 agent: Dropped the node name from snapshots.
+ *        Oct 17 2026 agent: Added parseShared.
+ *        Oct 17 2026 agent: Added calibrate.
+ *        Oct 17 2026 agent: Added getMappedFiles and FileUriTable::isRemote.
+ *        Oct 17 2026 agent: Added resolveLinks and setResolveLinks.
+ *        Oct 17 2026 agent: Added MPA_canonicalizePath and setCanonicalizePaths.
+ *        Oct 17 2026 agent: Included MountPointAttrStats.h.
+ *        Oct 17 2026 agent: Added parseForPid.
+ *        Oct 17 2026 agent: Added parse and parseRc on a given file.
+ *        Oct 17 2026 agent: Added FileUriTable and getFileUriInfoBulk.
+ *        Oct 17 2026 agent: Added FileUriInfo::getUriHash.
+ *        Oct 17 2026 agent: Added fs_overlay.
+ *        Oct 17 2026 agent: Added AUFS branch layouts.
+ *        Oct 17 2026 agent: Added getFileUriInfoByDev and getFileUriInfoForFd.
+ *        Oct 17 2026 agent: Added the mountinfo fields of MyMntEnt.
+ *        Oct 17 2026 agent: FileUriInfo shares its URI scheme.
+ *        Oct 17 2026 agent: Added MyMntEnt::fstype.
+ *        Oct 17 2026 agent: Added refreshRc and the mount table watch.
+ *        Oct 17 2026 agent: Added MountTableSnapshot.
+ *        Oct 17 2026 agent: Added MPAErrorCode and the *Rc methods.
+ *        Oct 17 2026 agent: Added getFileUriInfoBatch.
+ *        Oct 17 2026 agent: Added MntPntTrie.
  *        May 27 2011 DHA: Added MyMntEnt::operator== and operator!=
  *        May 23 2011 DHA: Added doxygen doxygen.
  *        May 23 2011 DHA: Moved internal data structure 
@@ -44,13 +68,22 @@ extern "C" {
 #include <string.h>
 #include <stdio.h>
 #include <limits.h>
+#include <pthread.h>
+#include <sys/types.h>
 }
 
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
 #include "FgfsCommon.h"
 #include "MountPointAttrUri.h"
+#include "MountPointAttrIndex.h"
+#include "MountPointAttrCache.h"
+#include "MountPointAttrHash.h"
+#include "MountPointAttrArena.h"
+#include "MountPointAttrStats.h"
+#include "MountPointAttrCalib.h"
 
 namespace FastGlobalFileStatus {
 
@@ -169,6 +202,16 @@ namespace FastGlobalFileStatus {
      const char FGFS_MOUNTS_FILE[] = "/proc/mounts";
 
 
+    /**
+     *   FGFS_MOUNTINFO_FILE
+     *   Defines the file that is parsed first. It has the same 
+     *   information as FGFS_MOUNTS_FILE plus the mount ID, the parent
+     *   mount ID, the device number and the root of each mount. 
+     *   FGFS_MOUNTS_FILE is used if this file isn't available.
+     */
+     const char FGFS_MOUNTINFO_FILE[] = "/proc/self/mountinfo";
+
+
     /**  FGFS_ALT_MOUNTS_FILE
      *   Defines an alternative file that contains the mount point
      *   info. On Linux, if /proc/mounts is not available for some
@@ -180,6 +223,31 @@ namespace FastGlobalFileStatus {
      const char FGFS_ALT_MOUNTS_FILE[] = "/etc/mtab";
 
 
+    /**  FGFS_SHARED_DIR
+     *   Defines the directory of the node-wide mount table images of
+     *   MountPointInfo::parseShared, unless $MPA_SHARED_DIR is set. 
+     *   It is served off of memory, so an image costs no disk I/O.
+     */
+     const char FGFS_SHARED_DIR[] = "/dev/shm";
+
+
+    /** FGFS_SHARED_MAX_AGE
+     *   Defines how many seconds a node-wide mount table image is 
+     *   reused before it is rebuilt from the mount point file, even
+     *   if no mount point has changed since.
+     */
+    const unsigned FGFS_SHARED_MAX_AGE = 60;
+
+
+    /** FGFS_READER_SLOTS
+     *   Defines how many reader counters a MountPointInfo object 
+     *   spreads its lookup threads over. Each counter sits on its own
+     *   cache line of FGFS_CACHE_LINE bytes.
+     */
+    const unsigned FGFS_READER_SLOTS = 16;
+    const unsigned FGFS_CACHE_LINE = 64;
+
+
     /** FGFS_STR_SIZE
      *   Defines the max string size
      */
@@ -234,9 +302,16 @@ namespace FastGlobalFileStatus {
         fs_selinux = 33, /*!< /selinux, pseudo file system, memory */
         fs_nfsd    = 34, /*!< /proc/fs/nfsd pseudo file system, memory */ 
         fs_cgroup  = 35, /*!< /proc/fs/cgroup pseudo file system, memory */ 
-        fs_unknown = 36  /*!< catch all */
+        fs_unknown = 36, /*!< catch all */
+        fs_overlay = 37  /*!< overlayfs union of layers (care is needed) */
     };
 
+    /**
+     *  Number of FileSystemType values. New types are appended after 
+     *  fs_unknown, so fs_unknown is not the last value. 
+     */
+    const int NUM_FS_TYPES = fs_overlay + 1;
+
 
     const int BASE_FS_SPEED = 1;
     const int BASE_FS_SCALABILITY = 1;
@@ -252,9 +327,91 @@ namespace FastGlobalFileStatus {
         unsigned short speed;
         unsigned short scalability;
         const char *fs_name;
+        bool remote;   /*!< served off of a remote file server */
+    };
+
+
+    /**
+     *   Maps a mount type string to a file system type. 
+     */
+    struct FileSystemTypeName {
+        const char *name;
+        FileSystemType t;
+    };
+
+
+    /**
+     *   Enumerates error conditions reported by MountPointInfo.
+     *
+     *   Unlike the C strings that the original methods return,
+     *   these codes require no memory allocation. MPA_errorString
+     *   maps each code to a static message.
+     */
+    enum MPAErrorCode {
+        err_none              = 0,  /*!< success */
+        err_null_path         = 1,  /*!< the given path is null */
+        err_not_absolute      = 2,  /*!< the given path is not absolute */
+        err_not_found         = 3,  /*!< no mount point covers the path */
+        err_ill_formed_fsname = 4,  /*!< remote file server source string is ill-formed */
+        err_path_mismatch     = 5,  /*!< mount point does not match the path prefix */
+        err_aufs_branch       = 6,  /*!< AUFS or overlay branches can't be resolved */
+        err_remote_check      = 7,  /*!< remote or local can't be determined */
+        err_no_node_name      = 8,  /*!< local node name is not available */
+        err_gethostname       = 9,  /*!< gethostname failed */
+        err_mounts_file       = 10, /*!< no mount point file can be opened */
+        err_batch_partial     = 11, /*!< some paths of a batch failed */
+        err_watch             = 12, /*!< mount table watch is inactive or failed */
+        err_bad_fd            = 13, /*!< file descriptor can't be resolved */
+        err_no_process        = 14, /*!< a process's mount namespace can't be accessed */
+        err_path_too_long     = 15, /*!< the canonical path doesn't fit in the buffer */
+        err_link_loop         = 16, /*!< too many symbolic links in a path */
+        err_calibration       = 17  /*!< mount point can't be probed */
     };
 
 
+    /**
+     *   Returns a static message describing an error code.
+     *
+     *   @param[in] ec an MPAErrorCode.
+     *   @return a C string that must not be freed.
+     */
+    const char *MPA_errorString(MPAErrorCode ec);
+
+
+    /**
+     *   Canonicalizes an absolute path by name alone: repeated slashes,
+     *   "." components and trailing slashes are dropped and each ".."
+     *   removes the component before it ("/.." is "/"). No system 
+     *   call is made, so links aren't resolved; ".." after a link 
+     *   to a directory yields a different path than the kernel would.
+     *
+     *   @param[in] path an absolute path.
+     *   @param[out] buf the canonical path; may be path itself.
+     *   @param[in] bufLen the size of buf.
+     *   @return err_none on success; otherwise an MPAErrorCode.
+     */
+    MPAErrorCode MPA_canonicalizePath(const char *path, 
+                                      char *buf, 
+                                      size_t bufLen);
+
+
+    /**
+     *   Sets the number of readlink results kept in the link cache
+     *   that resolveLinks shares across threads and MountPointInfo
+     *   objects. Least recently used results are evicted first.
+     *
+     *   @param[in] capacity maximum number of results; 0 disables 
+     *                       the cache.
+     */
+    void MPA_setLinkCacheSize(size_t capacity);
+
+    /**
+     *   Drops all results of the link cache, e.g., after links 
+     *   have been changed.
+     */
+    void MPA_clearLinkCache();
+
+
     /**
      *   Defines a data type to store file source information.
      *   It stores a URI scheme for the source as well. The tuple
@@ -273,18 +430,164 @@ namespace FastGlobalFileStatus {
             std::string mountPoint;  /*!< local mount point corresponding to exportDir */
 
             /**
-             *   Returns a globally unique id in the form of a URI string
+             *   Returns a globally unique id in the form of a URI string.
+             *   The URI reflects hostAddr and exportDir as they are now, 
+             *   even if the caller changed them after the lookup.
+             *
              *   @param[out] uri buffer to store the URI string
              *
              *   @return true on success.
              */
             bool getUri(std::string &uri) const;
 
+            /**
+             *   Returns a 128-bit digest of the URI string that getUri 
+             *   returns, without composing the string. Two files have 
+             *   the same digest if and only if (barring collisions) 
+             *   they have the same URI, on any node.
+             *
+             *   @param[out] hash the digest.
+             *
+             *   @return true on success.
+             */
+            bool getUriHash(UriHash &hash) const;
+
         private:
             FileUriInfo(const FileUriInfo &i);
             FileUriInfo & operator=(const FileUriInfo &rhs); 
-            UriScheme *uscheme;
+ 
+            //
+            // Schemes are shared and stateless; this object doesn't own it.
+            //
+            const UriScheme *uscheme;
+            std::string uriPrefix;
+            UriHasher prefixHash;  /*!< state after hashing uriPrefix */
+
+            //
+            // hostAddr and exportDir as uriPrefix was composed from. 
+            // If the caller has changed them since, the prefix is 
+            // composed again from the current values.
+            //
+            std::string prefixHostAddr;
+            std::string prefixExportDir;
+
+            bool prefixIsCurrent() const;
+
             friend class MountPointInfo; 
+            friend class MountTableSnapshot; 
+            friend class FileUriTable; 
+    };
+
+
+    /**
+     *   Defines a compact container of the FileUriInfo of many paths.
+     *
+     *   The fields that depend only on the mount point (hostAddr, 
+     *   exportDir, mountPoint and the URI prefix) are stored once per
+     *   mount point and referred to by a mount id; each path only keeps
+     *   its pathFromExportDir, which is copied into an arena. Filled by
+     *   getFileUriInfoBulk.
+     */
+    class FileUriTable {
+        public:
+            FileUriTable();
+            ~FileUriTable();
+
+            /**
+             *   Empties the table and frees its storage.
+             */
+            void clear();
+
+            /**
+             *   Returns the number of paths in the table.
+             */
+            size_t size() const;
+
+            /**
+             *   Returns err_none if the i-th path was resolved; otherwise
+             *   the code getFileUriInfoRc returned for it.
+             */
+            MPAErrorCode getError(size_t i) const;
+
+            /**
+             *   Returns pathFromExportDir of the i-th path; NULL if the 
+             *   path wasn't resolved. The string is owned by the table.
+             */
+            const char * getPathFromExportDir(size_t i) const;
+
+            /**
+             *   Returns the mount id of the i-th path; -1 if the path 
+             *   wasn't resolved. Paths with the same mount id share 
+             *   hostAddr, exportDir and mountPoint.
+             */
+            int getMountId(size_t i) const;
+
+            /**
+             *   Returns the number of distinct mount ids.
+             */
+            size_t getNumMounts() const;
+
+            const std::string & getHostAddr(int mountId) const;
+            const std::string & getExportDir(int mountId) const;
+            const std::string & getMountPoint(int mountId) const;
+
+            /**
+             *   Returns whether the paths of a mount id are served by 
+             *   a remote file server.
+             */
+            bool isRemote(int mountId) const;
+
+            /**
+             *   Identical as FileUriInfo::getUri of the i-th path.
+             */
+            bool getUri(size_t i, std::string &uri) const;
+
+            /**
+             *   Identical as FileUriInfo::getUriHash of the i-th path.
+             */
+            bool getUriHash(size_t i, UriHash &hash) const;
+
+            /**
+             *   Expands the i-th path into a FileUriInfo object.
+             *
+             *   @return true on success; false if the path wasn't resolved.
+             */
+            bool getFileUriInfo(size_t i, FileUriInfo &fui) const;
+
+        private:
+            FileUriTable(const FileUriTable &o);
+            FileUriTable & operator=(const FileUriTable &rhs);
+
+            /**
+             *   Returns the mount id of fui's mount point, adding one if 
+             *   it is new. This can be called concurrently.
+             */
+            int internMount(const FileUriInfo &fui);
+
+            struct Mount {
+                const UriScheme *uscheme;
+                std::string hostAddr;
+                std::string exportDir;
+                std::string mountPoint;
+                std::string uriPrefix;
+                UriHasher prefixHash;
+                bool remote;
+            };
+
+            struct Entry {
+                const char *path;   /*!< pathFromExportDir in an arena */
+                unsigned len;
+                int mount;          /*!< -1 if err isn't err_none */
+                MPAErrorCode err;
+            };
+
+            std::vector<Entry> entries;
+            std::vector<Mount> mounts;
+            std::map<std::string, int> mountIds;
+            std::vector<StringArena *> arenas; /*!< one per filling thread */
+            pthread_mutex_t lock;              /*!< guards the members above 
+                                                    but entries while filling */
+            friend class MountTableSnapshot; 
     };
 
 
@@ -299,17 +602,499 @@ namespace FastGlobalFileStatus {
             explicit MyMntEnt(struct mntent &m);
             ~MyMntEnt();
             MyMntEnt & operator=(const MyMntEnt &rhs);
-            bool operator==(const MyMntEnt &rhs);
-            bool operator!=(const MyMntEnt &rhs);
+            bool operator==(const MyMntEnt &rhs) const;
+            bool operator!=(const MyMntEnt &rhs) const;
             const std::string & getRealMountPointDir() const;
 
             std::string fsname;     /*!< Device or server for filesystem. */
             std::string dir_master; /*!< Directory mounted on. */
             std::string dir_branch; /*!< Directory mounted on. It points to the RW dir in the case of unionfs*/
             std::string type;       /*!< Type of filesystem: ufs, nfs, etc. */
+            FileSystemType fstype;  /*!< type resolved into FileSystemType. */
             std::string opts;       /*!< Comma-separated options for fs. */
             int freq;               /*!< Dump frequency (in days). */
             int passno;             /*!< Pass number for `fsck'. */
+            int mnt_id;             /*!< mount ID; -1 if unknown. */
+            int parent_id;          /*!< mount ID of the parent mount; -1 if unknown. */
+            dev_t dev;              /*!< st_dev of files on this mount; 0 if unknown. */
+            std::string root;       /*!< directory of the file system mounted on dir_master. */
+    };
+
+
+    /**
+     *   Defines an immutable view of the mount point database. 
+     *
+     *   A snapshot is built by MountPointInfo::parse and never changes
+     *   once published, so any number of threads can query it 
+     *   concurrently without locking. Snapshots are reference counted: 
+     *   one obtained through MountPointInfo::getSnapshot stays valid 
+     *   even after the MountPointInfo object re-parses or is destroyed.
+     *   The query methods have the same semantics as those of 
+     *   MountPointInfo.
+     */
+    class MountTableSnapshot {
+        public:
+            MPAErrorCode getMntPntInfoRc(const char *path,
+                                         MyMntEnt &result) const;
+
+            MPAErrorCode getMntPntInfo2Rc(const char *path,
+                                          MyMntEnt &result) const;
+
+            MPAErrorCode getFileUriInfoRc(const char *path, 
+                                          FileUriInfo &fui) const;
+
+            MPAErrorCode getFileUriInfoByDev(dev_t dev,
+                                             const char *path, 
+                                             FileUriInfo &fui) const;
+
+            MPAErrorCode getFileUriInfoForFd(int fd, FileUriInfo &fui) const;
+
+            MPAErrorCode getFileUriInfoBatch(const std::vector<const char *> &paths,
+                                             std::vector<FileUriInfo> &fuis,
+                                             std::vector<MPAErrorCode> &errs,
+                                             unsigned nthreads = 0) const;
+
+            MPAErrorCode getFileUriInfoBulk(const std::vector<const char *> &paths,
+                                            FileUriTable &table,
+                                            unsigned nthreads = 0) const;
+
+            MPAErrorCode getMappedFiles(pid_t pid,
+                                        std::vector<std::string> &paths,
+                                        FileUriTable &table,
+                                        unsigned nthreads = 0) const;
+
+            FGFSInfoAnswer isRemoteFileSystem(const char *path, 
+                                              MyMntEnt &result) const;
+
+            FGFSInfoAnswer isLocalDevice(const char *path,
+                                         MyMntEnt &result) const;
+
+            const std::map<std::string, MyMntEnt> &getMntPntMap() const;
+
+            MPAErrorCode getMountDigest(const char *dir, UriHash &digest) const;
+
+            void getTableDigest(UriHash &digest, bool remoteOnly = false) const;
+
+            void getTableDigest(const std::vector<std::string> &dirs,
+                                UriHash &digest) const;
+
+            /**
+             *   Returns the generation of this snapshot. Each snapshot 
+             *   a MountPointInfo object publishes has a higher generation
+             *   than the one it replaces.
+             */
+            unsigned long getGeneration() const;
+
+            /**
+             *   Configures the cache of union branch probes. See
+             *   MountPointInfo::setUnionProbeCache.
+             */
+            void setUnionProbeCache(size_t capacity, bool negative) const;
+
+            /**
+             *   Drops cached union branch probes. See
+             *   MountPointInfo::invalidateUnionProbeCache.
+             */
+            void invalidateUnionProbeCache(const char *path = NULL) const;
+
+            /**
+             *   Resolves the symbolic links of the directory components
+             *   of a path. See MountPointInfo::setResolveLinks.
+             *
+             *   @param[in] path an absolute path.
+             *   @param[out] buf the resolved path; may be path itself.
+             *   @param[in] bufLen the size of buf.
+             *   @param[in] remote whether links under remote mount 
+             *                     points are followed.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode resolveLinks(const char *path, 
+                                      char *buf, 
+                                      size_t bufLen,
+                                      bool remote = false) const;
+
+        private:
+            MountTableSnapshot();
+            ~MountTableSnapshot();
+            MountTableSnapshot(const MountTableSnapshot &o);
+            MountTableSnapshot & operator=(const MountTableSnapshot &rhs);
+
+            /**
+             *   Determines if a path is remotely served or not for a union 
+             *   file system (AUFS or overlay).
+             *
+             *   @param[in] path an absolute path that contains no links.
+             *   @param[in] idx the index of the union mount point entry of path.
+             *   @param[out] result the mount point entry of that path of MyMntEnt type.
+             *   @param[out] branch the index of the branch that holds path.
+             *   @return an answer of MNPInfoAnswer type.
+             */
+            FGFSInfoAnswer isUnionRemote(const char *path, 
+                                         int idx,
+                                         MyMntEnt &result,
+                                         size_t &branch) const;
+
+            /**
+             *   The part of FileUriInfo that depends only on the mount 
+             *   point: computed once per mount point when the snapshot 
+             *   is built.
+             */
+            struct MountUriRecord {
+                MountUriRecord() : scheme(NULL), err(err_none), wholePath(false) { }
+
+                const UriScheme *scheme;
+                std::string hostAddr;
+                std::string exportDir;
+                std::string uriPrefix; /*!< the URI up to pathFromExportDir */
+                UriHasher prefixHash;  /*!< state after hashing uriPrefix */
+                MPAErrorCode err;      /*!< set if fsname is ill-formed */
+                bool wholePath;        /*!< pathFromExportDir is the full path */
+            };
+
+            /**
+             *   A branch (layer) of a union mount point, classified when 
+             *   the snapshot is built.
+             */
+            struct UnionBranch {
+                UnionMountBranch branch; /*!< um_branch ends with '/' */
+                MyMntEnt entry;          /*!< the mount point holding the branch */
+                FGFSInfoAnswer remote;   /*!< ans_error if entry is unknown */
+                MountUriRecord uri;      /*!< of entry if remote is ans_yes */
+                bool writable;           /*!< AUFS rw branch or overlay upperdir */
+            };
+
+            /**
+             *   The branches of a union mount point, top-most first. 
+             *   Empty for other file system types.
+             */
+            struct UnionLayout {
+                UnionLayout() : valid(false) { }
+
+                std::vector<UnionBranch> branches;
+                bool valid;
+            };
+
+            /**
+             *   Returns path relative to the union mount point myEntry.
+             */
+            static std::string unionPathSuffix(const char *path, 
+                                               const MyMntEnt &myEntry);
+
+            /**
+             *   Checks if suffix exists under branch br, going through 
+             *   unionProbeCache.
+             */
+            bool existsInBranch(const UnionBranch &br, 
+                                const std::string &suffix) const;
+
+            /**
+             *   Appends a branch to layout, classifying it by the mount 
+             *   point that holds it.
+             */
+            void addUnionBranch(UnionLayout &layout, 
+                                const std::string &dir, 
+                                const std::string &perm,
+                                bool writable) const;
+
+            /**
+             *   Rebuilds unionLayouts from indexedEntries. The trie and
+             *   uriRecords must already be built.
+             */
+            void buildUnionLayouts();
+
+            /**
+             *   Checks if any branch of layout is on a remote mount point.
+             */
+            static bool hasRemoteBranch(const UnionLayout &layout);
+
+            /**
+             *   Builds the MountUriRecord of a remote mount point entry.
+             *   The file server name of a host:/export or //server/share
+             *   source is replaced with its canonical name (see 
+             *   MPA_setServerResolver), so that is done once per mount 
+             *   point rather than per file.
+             *
+             *   @param[in] myEntry a remote mount point entry.
+             *   @param[out] rec the record.
+             */
+            static void makeUriRecord(const MyMntEnt &myEntry, 
+                                      MountUriRecord &rec);
+
+            /**
+             *   Fills fui for a path whose mount point entry and remote or
+             *   local answer have already been determined.
+             *
+             *   @param[in] path an absolute path that contains no links.
+             *   @param[in] rc the answer of isRemoteFileSystem on path.
+             *   @param[in] myEntry the mount point entry of path.
+             *   @param[in] rec the record of myEntry; unused if rc is ans_no.
+             *   @param[out] fui path's source information of FileUriInfo type.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode fillFileUriInfo(const char *path,
+                                         FGFSInfoAnswer rc,
+                                         const MyMntEnt &myEntry,
+                                         const MountUriRecord &rec,
+                                         FileUriInfo &fui) const;
+
+            /**
+             *   Validates a path and finds the index of its mount point 
+             *   entry in indexedEntries.
+             *
+             *   @param[in] path an absolute path that contains no links.
+             *   @param[out] idx the index of the mount point entry.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode lookupEntry(const char *path, int &idx) const;
+
+            /**
+             *   The directory of the last path a batch or bulk worker
+             *   has looked up and the index of its mount point entry.
+             */
+            struct DirMemo {
+                DirMemo() : idx(-1), usable(false) { }
+
+                std::string dir;
+                int idx;
+                bool usable;  /*!< no mount point lies directly in dir */
+            };
+
+            /**
+             *   Identical as lookupEntry except that a path in the same 
+             *   directory as the previous path of memo is answered from 
+             *   memo without a walk of the trie. The answer carries over
+             *   only if no mount point lies directly in that directory
+             *   (mountParents), as the last component could be one.
+             *
+             *   @param[in] path an absolute path that contains no links.
+             *   @param[out] idx the index of the mount point entry.
+             *   @param[in,out] memo the calling worker's memo.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode lookupEntryMemo(const char *path, 
+                                         int &idx, 
+                                         DirMemo &memo) const;
+
+            /**
+             *   Reads a directory link through the link cache.
+             *
+             *   @param[in] dir an absolute path without links.
+             *   @param[in] remote whether dir may be under a remote 
+             *                     mount point.
+             *   @param[out] target the link's target.
+             *   @return true if dir is a link to be followed.
+             */
+            bool readDirLink(const std::string &dir, 
+                             bool remote, 
+                             std::string &target) const;
+
+            /**
+             *   Finds the mount point entry of a device through devSlots.
+             *
+             *   @param[in] dev a device number as in st_dev.
+             *   @param[in] path an absolute path to a file on dev.
+             *   @return the index of the deepest mount of dev that is 
+             *           a prefix of path; -2 if dev is indexed but 
+             *           none of its mounts is; -1 if dev isn't indexed.
+             */
+            int lookupDev(dev_t dev, const char *path) const;
+
+            /**
+             *   Fills fui for a path given the index of its mount point entry.
+             */
+            MPAErrorCode fillFromEntry(const char *path, 
+                                       int idx, 
+                                       FileUriInfo &fui) const;
+
+            static size_t hashDev(dev_t dev);
+
+            /**
+             *   Rebuilds devSlots and devNext from indexedEntries.
+             */
+            void buildDevIndex();
+
+            /**
+             *   A slot of the open-addressing hash table of devices.
+             */
+            struct DevSlot {
+                dev_t dev;
+                int first;  /*!< first entry of dev; -1 if the slot is empty */
+            };
+
+            /**
+             *   Finds the mount point entry of a path and determines whether
+             *   the path is remotely served. This is the common logic of 
+             *   isRemoteFileSystem, getMntPntInfo2 and getFileUriInfo.
+             *
+             *   @param[in] path an absolute path that contains no links.
+             *   @param[out] result the mount point entry of that path of MyMntEnt type.
+             *   @param[out] answer an answer of MNPInfoAnswer type.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode classifyPath(const char *path,
+                                      MyMntEnt &result,
+                                      FGFSInfoAnswer &answer) const;
+
+            /**
+             *   Shared state of the threads of a getFileUriInfoBatch call.
+             */
+            struct BatchUriJob {
+                const MountTableSnapshot *snap;
+                const std::vector<const char *> *paths;
+                std::vector<FileUriInfo> *fuis;
+                std::vector<MPAErrorCode> *errs;
+                volatile size_t next;    /*!< next path to be claimed */
+                volatile size_t nfailed; /*!< number of failed paths */
+            };
+
+            /**
+             *   Thread routine of getFileUriInfoBatch. 
+             *
+             *   @param[in] arg a BatchUriJob object.
+             *   @return NULL.
+             */
+            static void * batchUriWorker(void *arg);
+
+            /**
+             *   Shared state of the threads of a getFileUriInfoBulk call.
+             */
+            struct BulkUriJob {
+                const MountTableSnapshot *snap;
+                const std::vector<const char *> *paths;
+                FileUriTable *table;
+                volatile size_t next;    /*!< next path to be claimed */
+                volatile size_t nfailed; /*!< number of failed paths */
+            };
+
+            /**
+             *   Thread routine of getFileUriInfoBulk. 
+             *
+             *   @param[in] arg a BulkUriJob object.
+             *   @return NULL.
+             */
+            static void * bulkUriWorker(void *arg);
+
+            /**
+             *   Rebuilds index and uriRecords from mntPntMap. This must be 
+             *   called whenever mntPntMap changes, before the snapshot is 
+             *   published.
+             *   Local mount points have no record: they share the
+             *   process-wide local node name, resolved on first use.
+             *
+             *   The URI record of a remote mount point whose entry is 
+             *   unchanged in prev is copied from prev rather than 
+             *   rebuilt, unless the server map or resolver has changed 
+             *   since. The trie, the device index and the union layouts
+             *   depend on the whole set of mount points, so they are 
+             *   always rebuilt in full.
+             *
+             *   @param[in] prev the snapshot this one replaces; NULL if 
+             *                   none.
+             */
+            void buildIndex(const MountTableSnapshot *prev = NULL);
+
+            /**
+             *   Completes the index of a snapshot read from an image 
+             *   (MPA_readTableImage), whose trie and device index are 
+             *   attached to the image. uriRecords are either loaded 
+             *   from the image, which leaves their schemes and prefix 
+             *   hashes to be set, or made here.
+             *
+             *   @param[in] urisLoaded whether uriRecords came from the 
+             *                         image.
+             */
+            void indexImage(bool urisLoaded);
+
+            /**
+             *   Builds what depends on the entries, uriRecords, the trie
+             *   and the device index: the union layouts, mountDigests 
+             *   and mountParents. Sets parsed.
+             */
+            void finishIndex();
+
+            /**
+             *   Returns a key of the configuration that names file 
+             *   servers: the server map in $MPA_SERVER_MAP. A table 
+             *   image carries its URI records to the processes that 
+             *   have the same key.
+             *
+             *   @param[out] key the key.
+             *   @return false if the server map or resolver has been 
+             *           set through the API, which other processes 
+             *           can't know.
+             */
+            static bool serverConfigKey(UriHash &key);
+
+            void ref() const;
+            void unref() const;
+
+            std::map<std::string, MyMntEnt> mntPntMap;
+            MntPntTrie index;
+            std::vector<const MyMntEnt *> indexedEntries;
+            std::vector<MountUriRecord> uriRecords; /*!< parallel to indexedEntries */
+            std::vector<DevSlot> devSlots;
+            std::vector<int> devNext;  /*!< next entry of the same device; -1 at the end */
+            const DevSlot *devSlotBase; /*!< devSlots or the image's */
+            size_t numDevSlots;
+            const int *devNextBase;     /*!< devNext or the image's */
+            std::vector<UnionLayout> unionLayouts; /*!< parallel to indexedEntries */
+            std::vector<UriHash> mountDigests;     /*!< parallel to indexedEntries */
+            std::set<std::string> mountParents;    /*!< parent directories of mount points */
+
+            //
+            // Probes of union branches are file system accesses and
+            // thus the one piece of mutable state of a snapshot. 
+            //
+            mutable LruCache<std::string, bool> unionProbeCache;
+            mutable bool unionNegativeCache;
+            mutable pthread_mutex_t unionCacheLock;
+            std::string mountsFile;   /*!< the file read; empty for the system's */
+            dev_t nsDev;              /*!< mount namespace of the table; 0 if none */
+            ino_t nsIno;
+            unsigned long generation;
+            unsigned long uriGeneration; /*!< serverGeneration at buildIndex */
+            bool parsed;                 /*!< set by buildIndex */
+            void *imageAddr;             /*!< mapped image of the index; NULL if none */
+            size_t imageSize;
+            mutable volatile int refCount;
+
+            friend class MountPointInfo;
+            friend class MountTableSnapshotRef;
+            friend bool MPA_writeTableImage(const std::string &path,
+                                            const MountTableSnapshot &snap,
+                                            const UriHash &state);
+            friend MountTableSnapshot *MPA_readTableImage(const std::string &path,
+                                                          unsigned maxAge,
+                                                          const UriHash &state);
+    };
+
+
+
+    /**
+     *   Defines a counted reference to a MountTableSnapshot. 
+     */
+    class MountTableSnapshotRef {
+        public:
+            MountTableSnapshotRef();
+            MountTableSnapshotRef(const MountTableSnapshotRef &o);
+            ~MountTableSnapshotRef();
+            MountTableSnapshotRef & operator=(const MountTableSnapshotRef &rhs);
+
+            const MountTableSnapshot * operator->() const { return snap; }
+            const MountTableSnapshot & operator*() const { return *snap; }
+            bool isNull() const { return (snap == NULL); }
+
+        private:
+            explicit MountTableSnapshotRef(const MountTableSnapshot *s);
+
+            /**
+             *   Detaches the snapshot from this object without dropping
+             *   the reference, which the caller takes over.
+             */
+            MountTableSnapshot * release();
+
+            const MountTableSnapshot *snap;
+            friend class MountPointInfo;
     };
 
 
@@ -317,8 +1102,9 @@ namespace FastGlobalFileStatus {
      *   Defines a data type that relates an arbiturary local file path to
      *   the mount point database. The local mount point DB has 
      *   sufficient information to resolve the file path to a globally
-     *   unique identifier in the form of URI. This abstraction strictly 
-     *   is limited to local, sequential processing.
+     *   unique identifier in the form of URI. The query methods 
+     *   are safe to call from multiple threads, including while another 
+     *   thread re-parses: each query runs against one MountTableSnapshot.
      */
     class MountPointInfo {
         public:
@@ -372,15 +1158,106 @@ namespace FastGlobalFileStatus {
              */
             const char * parse();
 
+            /**
+             *   Identical as parse except that it returns an error code.
+             *
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode parseRc();
+
+            /**
+             *   Identical as parse except that the mount points are read
+             *   from the given file, in the /proc/mounts or the 
+             *   /proc/self/mountinfo format, instead of the system's 
+             *   files. refresh re-reads the same file. This is meant for 
+             *   testing and benchmarking against mount tables of other 
+             *   systems.
+             *
+             *   @param[in] mountsFile the mount point file; NULL reads 
+             *                         the system's files.
+             *   @return a C string if an error is encountered; otherwise NULL.
+             */
+            const char * parse(const char *mountsFile);
+
+            /**
+             *   Identical as parse(mountsFile) except that it returns an
+             *   error code.
+             *
+             *   @param[in] mountsFile the mount point file; NULL reads 
+             *                         the system's files.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode parseRc(const char *mountsFile);
+
+            /**
+             *   Builds the database from the mount namespace of another
+             *   process, i.e., from /proc/<pid>/mountinfo. Mount point 
+             *   directories, and so the paths to query, are as that 
+             *   process sees them, e.g., within its container.
+             *
+             *   Tables are cached process-wide by the inode of 
+             *   /proc/<pid>/ns/mnt: all the processes of a namespace 
+             *   share a single parsed table, so the file is parsed only
+             *   for the first of them. refresh re-reads the file of the 
+             *   process and updates the cached table. 
+             *
+             *   @param[in] pid the process id.
+             *   @return err_none on success; err_no_process if the 
+             *           namespace of pid can't be accessed; otherwise 
+             *           an MPAErrorCode.
+             */
+            MPAErrorCode parseForPid(pid_t pid);
+
+            /**
+             *   Identical as parseRc except that the table is parsed 
+             *   once per node, e.g., by the first of the MPI ranks 
+             *   that start on it, and shared with the others. 
+             *
+             *   The first caller parses the system's files and writes 
+             *   the table as a read-only image into dir. The image is 
+             *   keyed by the user and the mount namespace. The other 
+             *   callers map the image and query its trie and device 
+             *   index in place, without parsing the mount point file 
+             *   or resolving file server names. Callers that arrive 
+             *   while the image is being built, under an flock on a 
+             *   lock file next to it, wait for it. Anyone failing to 
+             *   use the image parses on its own, so the result is the 
+             *   same either way. refresh reads the system's files as 
+             *   usual.
+             *
+             *   An image records a digest of the mount point file it 
+             *   was built from, and a caller only takes it if its own 
+             *   mount point file has the same digest, so a mount or an
+             *   unmount in the namespace makes the next caller rebuild
+             *   it. Computing the digest reads the file but costs far 
+             *   less than a parse.
+             *
+             *   @param[in] dir the directory of the image; NULL means 
+             *                  $MPA_SHARED_DIR or FGFS_SHARED_DIR.
+             *   @param[in] maxAge seconds an image of the current mount
+             *                     table is reused.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode parseShared(const char *dir = NULL,
+                                     unsigned maxAge = FGFS_SHARED_MAX_AGE);
+
+            /**
+             *   Drops the tables that parseForPid cached. Objects that 
+             *   use them keep them until they parse again. Call this 
+             *   when the processes of interest are gone: a namespace 
+             *   inode can be reused once its namespace is destroyed.
+             */
+            static void clearNamespaceTables();
+
             /**
              *   Returns a mount point entry corresponding to the given absolute path.
              *
              *   Note that the method bases its operation solely on the name: 
              *   any given absolute path will be resolved even if it is nonexistent 
-             *   or you don't proper access to the path. Starting from the longest path 
-             *   of the given path, which is the path itself, this method will compare 
-             *   progressively shorter sub-paths of the path with the mount point database
-             *   until it finds a match. For high scalability, we must avoid flooding 
+             *   or you don't proper access to the path. This method scans the path 
+             *   one component at a time against a trie of the mount point directories,
+             *   which parse builds, and picks the longest mount point that is 
+             *   a prefix of the path. For high scalability, we must avoid flooding 
              *   file servers even for metadata operations. This trade-off was made 
              *   because of that reason. Users should ensure the path is valid 
              *   before calling this method. 
@@ -392,6 +1269,16 @@ namespace FastGlobalFileStatus {
             const char * getMntPntInfo(const char *path,
                                        MyMntEnt &result) const;
 
+            /**
+             *   Identical as getMntPntInfo except that it returns an error code.
+             *
+             *   @param[in] path an absolute path that contains no links.
+             *   @param[out] result the mount point entry of that path of MyMntEnt type.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode getMntPntInfoRc(const char *path,
+                                         MyMntEnt &result) const;
+
             /**
              *   Returns a mount point entry corresponding to the given absolute path.
              * 
@@ -408,6 +1295,16 @@ namespace FastGlobalFileStatus {
             const char * getMntPntInfo2(const char *path,
                                        MyMntEnt &result) const;
 
+            /**
+             *   Identical as getMntPntInfo2 except that it returns an error code.
+             *
+             *   @param[in] path an absolute path that contains no links.
+             *   @param[out] result the mount point entry of that path of MyMntEnt type.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode getMntPntInfo2Rc(const char *path,
+                                          MyMntEnt &result) const;
+
             /**
              *   Returns remote file server origin information that corresponds to a path.
              *
@@ -426,7 +1323,130 @@ namespace FastGlobalFileStatus {
              *   @return a C string if an error is encountered; otherwise NULL.
              */
             const char * getFileUriInfo(const char *path, 
-                                        FileUriInfo &fui);
+                                        FileUriInfo &fui) const;
+
+            /**
+             *   Identical as getFileUriInfo except that it returns an error code.
+             *
+             *   @param[in] path an absolute path that contains no links.
+             *   @param[out] fui path's source information of FileUriInfo type.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode getFileUriInfoRc(const char *path, 
+                                          FileUriInfo &fui) const;
+
+            /**
+             *   Returns remote file server origin information for a set of paths.
+             *
+             *   This call is identical as calling getFileUriInfo on each path
+             *   except that the paths are resolved by a pool of threads against 
+             *   this one mount point database. The remote or local nature of 
+             *   each mount point, along with its URI prefix, is computed once 
+             *   per snapshot when the table is parsed (MountUriRecord), so 
+             *   no path pays for it. Each thread also remembers the mount 
+             *   point of the last directory it has looked up, so consecutive 
+             *   paths in one directory walk the mount point trie once. Sort 
+             *   the paths to make the most of it. Use this to check an 
+             *   application's executable and shared libraries, or an entire 
+             *   input deck, at once.
+             *
+             *   @param[in] paths absolute paths that contain no links.
+             *   @param[out] fuis source information of each path. The vector 
+             *                    is replaced with one that has as many elements 
+             *                    as paths, in the same order.
+             *   @param[out] errs per-path error status: err_none if the path 
+             *                    is resolved into its fuis element; otherwise 
+             *                    the code getFileUriInfoRc would return. 
+             *   @param[in] nthreads the number of threads to use including 
+             *                    the calling thread. 0 uses one thread per 
+             *                    online core.
+             *   @return err_batch_partial if any of the paths failed; 
+             *           otherwise err_none.
+             */
+            MPAErrorCode getFileUriInfoBatch(const std::vector<const char *> &paths,
+                                             std::vector<FileUriInfo> &fuis,
+                                             std::vector<MPAErrorCode> &errs,
+                                             unsigned nthreads = 0) const;
+
+            /**
+             *   Identical as getFileUriInfoBatch except that the results 
+             *   are stored in a FileUriTable, which keeps the per-mount 
+             *   point fields once per mount point instead of once per 
+             *   path. Use this for very large sets of paths.
+             *
+             *   @param[in] paths absolute paths that contain no links.
+             *   @param[out] table replaced with the results of the paths
+             *                     in the same order.
+             *   @param[in] nthreads as in getFileUriInfoBatch.
+             *   @return err_batch_partial if any of the paths failed; 
+             *           otherwise err_none.
+             */
+            MPAErrorCode getFileUriInfoBulk(const std::vector<const char *> &paths,
+                                            FileUriTable &table,
+                                            unsigned nthreads = 0) const;
+
+            /**
+             *   Resolves the files a process has mapped: its executable 
+             *   and shared libraries, and any other mapped file. Each 
+             *   file is listed once, the executable first and the rest
+             *   in the order of /proc/<pid>/maps. The files are resolved
+             *   as in getFileUriInfoBulk, so the per-mount point work is 
+             *   done once per mount and the results can be grouped by 
+             *   FileUriTable::getMountId. The paths are those of the 
+             *   process's mount namespace; parse the table of a process 
+             *   in another namespace with parseForPid first.
+             *
+             *   @param[in] pid the process.
+             *   @param[out] paths replaced with the mapped files.
+             *   @param[out] table replaced with the results of paths
+             *                     in the same order.
+             *   @param[in] nthreads as in getFileUriInfoBatch.
+             *   @return err_no_process if the maps of pid can't be read;
+             *           err_batch_partial if any of the files failed; 
+             *           otherwise err_none.
+             */
+            MPAErrorCode getMappedFiles(pid_t pid,
+                                        std::vector<std::string> &paths,
+                                        FileUriTable &table,
+                                        unsigned nthreads = 0) const;
+
+            /**
+             *   Returns remote file server origin information of a file 
+             *   whose device number is known, e.g., from stat(2).
+             *
+             *   The mount point is found through a hash table keyed by the 
+             *   device numbers in /proc/self/mountinfo instead of by name. 
+             *   If several mount points share the device (bind mounts), 
+             *   the deepest one that is a prefix of path is used. If none 
+             *   of them is, the links of path are resolved as resolveLinks 
+             *   does, through the link cache and without following links 
+             *   under remote mount points; err_path_mismatch is returned 
+             *   if that doesn't lead to a mount point of the device 
+             *   either. If the device isn't in the table, this
+             *   falls back to getFileUriInfo on path.
+             *
+             *   @param[in] dev the st_dev of the file.
+             *   @param[in] path an absolute path to the file.
+             *   @param[out] fui file's source information of FileUriInfo type.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode getFileUriInfoByDev(dev_t dev,
+                                             const char *path, 
+                                             FileUriInfo &fui) const;
+
+            /**
+             *   Returns remote file server origin information of an open file.
+             *   The device number comes from fstat(2) and the path from 
+             *   /proc/self/fd, which the kernel keeps free of links. 
+             *
+             *   @param[in] fd an open file descriptor.
+             *   @param[out] fui file's source information of FileUriInfo type.
+             *   @return err_none on success; err_bad_fd if fd can't be 
+             *           resolved; err_not_absolute if fd isn't a file 
+             *           in the file system name space; otherwise 
+             *           an MPAErrorCode.
+             */
+            MPAErrorCode getFileUriInfoForFd(int fd, FileUriInfo &fui) const;
 
             /**
              *   Determines if a path is remotely served or not.
@@ -498,6 +1518,81 @@ namespace FastGlobalFileStatus {
             const int getScalability(FileSystemType t) const; 
 
 
+            /**
+             *   Measures the performance of each mount point of 
+             *   a storage file system, reusing the results in 
+             *   opts.cacheFile that are fresh and saving the new ones 
+             *   there. Pseudo file systems and union mounts are skipped 
+             *   and mount points that can't be probed are left out. 
+             *
+             *   @param[in] opts bounds of the probes and the cache file.
+             *   @return err_none if every mount point was calibrated, 
+             *           including when there is none to calibrate; 
+             *           err_batch_partial if some of them couldn't be 
+             *           probed; err_calibration if none could.
+             */
+            MPAErrorCode calibrate(const CalibrationOptions &opts);
+
+            /**
+             *   Measures the performance of the mount point of dir, 
+             *   probing in dir itself, e.g., a scratch directory the 
+             *   caller can write to.
+             *
+             *   @param[in] dir a directory.
+             *   @param[in] opts bounds of the probes and the cache file.
+             *   @return err_none on success; err_calibration if no probe
+             *           succeeded; otherwise an MPAErrorCode of the 
+             *           lookup of dir.
+             */
+            MPAErrorCode calibrate(const char *dir, 
+                                   const CalibrationOptions &opts);
+
+            /**
+             *   Takes the fresh results in opts.cacheFile for the 
+             *   current mount points without probing.
+             *
+             *   @param[in] opts the cache file and maxAge.
+             *   @return err_none; err_calibration if the cache file 
+             *           can't be read.
+             */
+            MPAErrorCode loadCalibration(const CalibrationOptions &opts);
+
+            /**
+             *   Returns the measured performance of a mount point.
+             *   Results are keyed by the mount point's source, type 
+             *   and options, so a remount with other options needs 
+             *   another calibration.
+             *
+             *   @param[in] ent the mount point entry.
+             *   @param[out] perf its measurements.
+             *   @return true if ent was calibrated.
+             */
+            bool getMountPerf(const MyMntEnt &ent, MountPerf &perf) const;
+
+            /**
+             *   Return the mount point's speed as a multiple of 
+             *   BASE_FS_SPEED: its measured streaming throughput in 
+             *   CALIB_SPEED_UNIT_MBPS if calibrated, the estimate 
+             *   of its FileSystemType otherwise.
+             *
+             *   @param[in] ent the mount point entry.
+             *   @return speed. 0 if an error is encountered.
+             */
+            const int getSpeed(const MyMntEnt &ent) const;
+
+            /**
+             *   Return the mount point's scalability as a multiple of 
+             *   BASE_FS_SCALABILITY: its measured metadata operation rate
+             *   in CALIB_SCALABILITY_UNIT_OPS if calibrated, the 
+             *   estimate of its FileSystemType otherwise. The rate is 
+             *   that of a single client.
+             *
+             *   @param[in] ent the mount point entry.
+             *   @return scalability. 0 if an error is encountered.
+             */
+            const int getScalability(const MyMntEnt &ent) const;
+
+
             /**
              *   Return File System's string name
              *
@@ -510,28 +1605,294 @@ namespace FastGlobalFileStatus {
            /**
              *   Returns the MntPntMap as immutable object
              *
-             *   @return a map object
+             *   @return a map object. It remains valid until the next 
+             *           parse on this object; use getSnapshot to keep 
+             *           it across a parse.
              */
             const std::map<std::string, MyMntEnt> &getMntPntMap() const;
 
+
+            /**
+             *   Returns the digest of a mount point, stable across nodes
+             *   and runs. It covers the mount point directory, the file 
+             *   system type and the source: the URI prefix, with the 
+             *   canonical server name, for a remote mount; for a union 
+             *   mount with a remote branch, the URI prefix of each 
+             *   remote branch's mount point with the branch's path in 
+             *   it and the path of each local branch; and fsname 
+             *   otherwise. Mount options and node-local numbers such as
+             *   mount IDs and device numbers are left out, so nodes 
+             *   that share a view of a mount get the same digest.
+             *
+             *   @param[in] dir a mount point directory.
+             *   @param[out] digest its digest.
+             *   @return err_none; err_not_found if dir isn't a mount point.
+             */
+            MPAErrorCode getMountDigest(const char *dir, UriHash &digest) const;
+
+            /**
+             *   Returns an order-independent digest of the table: nodes
+             *   whose mount points have the same digests get the same 
+             *   table digest regardless of the order in which they were
+             *   mounted, so one 16-byte value per node can be reduced 
+             *   before any detailed comparison.
+             *
+             *   @param[out] digest the table digest.
+             *   @param[in] remoteOnly restricts it to remote mount points
+             *                         and union mount points with 
+             *                         a remote branch.
+             */
+            void getTableDigest(UriHash &digest, bool remoteOnly = false) const;
+
+            /**
+             *   Identical as getTableDigest except that it covers the 
+             *   given mount point directories only. A directory that 
+             *   isn't a mount point still counts as absent, so a node 
+             *   lacking a mount differs from one that has it.
+             *
+             *   @param[in] dirs mount point directories; duplicates 
+             *                   count once.
+             *   @param[out] digest the digest of those mount points.
+             */
+            void getTableDigest(const std::vector<std::string> &dirs,
+                                UriHash &digest) const;
+
+            /**
+             *   Returns a reference to the current mount point database.
+             *   The snapshot doesn't change when this object re-parses, 
+             *   so use this to get results that are consistent with 
+             *   each other across several calls.
+             *
+             *   @return a MountTableSnapshotRef object.
+             */
+            MountTableSnapshotRef getSnapshot() const;
+
+            /**
+             *   Re-reads the mount point file and applies only the mount
+             *   points that have been added or removed since the current 
+             *   table was built. Unlike parse, this doesn't resolve the 
+             *   local node name again. If nothing changed, the current 
+             *   table and the generation are kept. If the object has not 
+             *   been parsed, this calls parse.
+             *
+             *   @param[out] changed true if a new table was published.
+             *   @return err_none on success; otherwise an MPAErrorCode.
+             */
+            MPAErrorCode refreshRc(bool &changed);
+
+            /**
+             *   Opens the mount point file of the current table for 
+             *   change notification. The kernel flags the file with 
+             *   POLLPRI and POLLERR when a file system is mounted or 
+             *   unmounted in the mount namespace of the table: that of
+             *   the caller after parse, and that of the process after 
+             *   parseForPid. A table parsed from any other file gets no
+             *   mount events.
+             *
+             *   @return err_none on success; err_watch if the table 
+             *           came from a file that can't be watched; 
+             *           otherwise err_mounts_file.
+             */
+            MPAErrorCode startWatch();
+
+            /**
+             *   Closes the file descriptor opened by startWatch.
+             */
+            void stopWatch();
+
+            /**
+             *   Returns the file descriptor opened by startWatch so that
+             *   it can be added to the caller's own event loop. Poll it 
+             *   for POLLPRI and call refreshRc when it becomes ready; 
+             *   the readiness is consumed by that poll, so calling 
+             *   waitForChange at that point would miss it.
+             *
+             *   @return a file descriptor; -1 if not watching.
+             */
+            int getWatchFd() const;
+
+            /**
+             *   Waits for a change notification on the mount point file 
+             *   and calls refreshRc if one arrives.
+             *
+             *   @param[in] timeout timeout in milliseconds as in poll(2): 
+             *                      0 returns immediately; -1 waits forever.
+             *   @param[out] changed true if a new table was published.
+             *   @return err_none on success or timeout; err_watch if 
+             *           startWatch hasn't been called or poll fails; 
+             *           otherwise an error of refreshRc.
+             */
+            MPAErrorCode waitForChange(int timeout, bool &changed);
+
+            /**
+             *   Returns the generation of the current table. It is 
+             *   incremented every time a new table is published.
+             *
+             *   @return the generation counter.
+             */
+            unsigned long getGeneration() const;
+
+            /**
+             *   Configures the cache of union branch probes. Whether a 
+             *   path under an AUFS or overlay mount is remote depends on 
+             *   the top-most branch in which it exists; the answers of 
+             *   these probes are cached per table. Read-only branches
+             *   (AUFS ro branches and overlay lowerdirs) don't change 
+             *   under a mount, so both answers are cached for them. 
+             *   For a writable branch, by default only positive answers
+             *   are cached, since a file can be created there at any 
+             *   time (copy-up). With negative caching, missing files and
+             *   directories of writable branches are cached as well and 
+             *   the application must call invalidateUnionProbeCache when 
+             *   the writable branch changes.
+             *
+             *   @param[in] capacity maximum number of cached probes; 0 
+             *                       disables the cache.
+             *   @param[in] negative whether missing files are cached.
+             */
+            void setUnionProbeCache(size_t capacity, bool negative);
+
+            /**
+             *   Drops cached union branch probes.
+             *
+             *   @param[in] path a path under a union mount point; the 
+             *                   probes of that path and everything below 
+             *                   it are dropped. NULL drops all of them.
+             */
+            void invalidateUnionProbeCache(const char *path = NULL) const;
+
+            /**
+             *   Makes the lookup methods of this object canonicalize 
+             *   the given path with MPA_canonicalizePath before the 
+             *   lookup, so that a path such as "/p/lscratch//foo/../bar/" 
+             *   finds the mount point of "/p/lscratch/bar" without 
+             *   the caller running realpath. The canonical path is built 
+             *   in a buffer on the stack and is what the trie walk and 
+             *   the resulting FileUriInfo use. Off by default, because 
+             *   ".." is resolved lexically. The batch and bulk methods 
+             *   take their paths as given.
+             *
+             *   @param[in] on whether paths are canonicalized.
+             */
+            void setCanonicalizePaths(bool on);
+
+            bool getCanonicalizePaths() const;
+
+            /**
+             *   Makes the lookup methods of this object follow the 
+             *   symbolic links of the directory components of a path, 
+             *   e.g., /usr/lib64 -> lib, so that the path is matched 
+             *   against the mount point it actually lives on. ".." and 
+             *   "." are resolved as the kernel would. The last component 
+             *   is taken as is, so a file costs no lstat of its own, and
+             *   mount point directories are never read. Each link is 
+             *   read once per process through the link cache (see 
+             *   MPA_setLinkCacheSize). Unless remote is set, components
+             *   under a remote mount point are taken as is as well so 
+             *   that file servers see no readlink traffic. Off by 
+             *   default; the batch and bulk methods take their paths 
+             *   as given.
+             *
+             *   @param[in] on whether links are followed.
+             *   @param[in] remote whether links under remote mount 
+             *                     points are followed too.
+             */
+            void setResolveLinks(bool on, bool remote = false);
+
+            bool getResolveLinks() const;
+
         private:
 
             /**
-             *   Determines if a path is remotely served or not for AUFS union file system.
+             *   Points path to its resolved or canonical form in buf 
+             *   if either is on; leaves it alone otherwise.
              *
-             *   @param[in] path an absolute path that contains no links.
-             *   @param[in] myEntry a MyMntEnt object describing mount point of the aufs path.
-             *   @param[out] result the mount point entry of that path of MyMntEnt type.
-             *   @return an answer of MNPInfoAnswer type.
+             *   @param[in] snap the snapshot of the lookup.
+             *   @param[in,out] path the path of a lookup.
+             *   @param[out] buf a buffer of PATH_MAX bytes.
+             *   @return err_none on success; otherwise an MPAErrorCode.
              */
-            FGFSInfoAnswer isAufsRemote(const char *path, 
-                                        MyMntEnt &myEntry,
-                                        MyMntEnt &result) const;
+            MPAErrorCode lookupPath(const MountTableSnapshot *snap,
+                                    const char *&path, 
+                                    char *buf) const;
 
-            UriScheme * createUriSchemeInstance(FileSystemType fst);
+            void initSnapshot(MountTableSnapshot *snap);
 
-            std::map<std::string, MyMntEnt> mMntPntMap;
-            bool parsed;
+            /**
+             *   Publishes a snapshot of the table image if it is valid, 
+             *   younger than maxAge seconds and of the mount state 
+             *   state (MPA_mountStateDigest).
+             *
+             *   @return true if the image was taken.
+             */
+            bool attachImage(const char *image, 
+                             unsigned maxAge, 
+                             const UriHash &state);
+
+            /**
+             *   Calibrates ent by probing in dir unless cache has 
+             *   a fresh result, which is then taken.
+             *
+             *   @param[in,out] dirty set if cache got a new result.
+             */
+            MPAErrorCode calibrateEntry(const MyMntEnt &ent, 
+                                        const char *dir,
+                                        const CalibrationOptions &opts,
+                                        MountPerfCache &cache,
+                                        bool &dirty);
+
+            /**
+             *   Enters a read section and returns the current snapshot.
+             *   The snapshot remains valid until exitRead.
+             *
+             *   @param[out] snap the current snapshot.
+             *   @return the epoch to be passed to exitRead.
+             */
+            unsigned long enterRead(const MountTableSnapshot *&snap) const;
+
+            void exitRead(unsigned long epoch) const;
+
+            /**
+             *   Makes snap the current snapshot, taking over the caller's 
+             *   reference, and releases the previous one once the readers 
+             *   that may still be using it have exited. The caller must 
+             *   hold mPublishLock.
+             */
+            void publish(MountTableSnapshot *snap);
+
+            MountTableSnapshot *mSnapshot;
+
+            /**
+             *   Counters of the readers of each epoch parity on one 
+             *   cache line, so that threads on different slots don't 
+             *   contend for it.
+             */
+            struct ReaderSlot {
+                volatile long count[2];
+                char pad[FGFS_CACHE_LINE - 2 * sizeof(long)];
+            };
+
+            //
+            // Left-right reader accounting: readers register in their 
+            // thread's slot under the parity of mReadEpoch, and publish 
+            // flips the epoch and waits for the old parity to drain in
+            // every slot. mReadEpoch only changes on publish, so it stays
+            // in the readers' caches; the pad keeps the slots off of 
+            // its line.
+            //
+            mutable volatile unsigned long mReadEpoch;
+            char mReadPad[FGFS_CACHE_LINE];
+            mutable ReaderSlot mReaders[FGFS_READER_SLOTS];
+            pthread_mutex_t mPublishLock;
+            volatile unsigned long mGeneration;
+            int mWatchFd;
+            size_t mUnionCacheCapacity;
+            bool mUnionNegativeCache;
+            bool mCanonicalize;
+            bool mResolveLinks;
+            bool mResolveRemoteLinks;
+            std::map<std::string, MountPerf> mPerf;
+            mutable pthread_mutex_t mPerfLock; /*!< guards mPerf */
     };
 
 
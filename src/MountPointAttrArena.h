@@ -0,0 +1,93 @@
+/*
+ * -------------------------------------------------------------------------------- 
+ * Copyright (c) 2011, Lawrence Livermore National Security, LLC. Produced at
+ * the Lawrence Livermore National Laboratory. Written by Dong H. Ahn <ahn1@llnl.gov>. 
+ * LLNL-CODE-490173. All rights reserved.
+ * 
+ * This file is part of MountPointAttributes. For details, 
+ * see https://computing.llnl.gov/?set=resources&page=os_projects
+ * 
+ * Please also read LICENSE - Our Notice and GNU Lesser General Public License.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under 
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the terms and conditions of the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA 02111-1307 USA
+ * --------------------------------------------------------------------------------
+ *
+ * Update Log:
+ *        Oct 17 2026 agent: File created.
+ *
+ */
+
+#ifndef MOUNT_POINT_ATTR_ARENA_H
+#define MOUNT_POINT_ATTR_ARENA_H 1
+
+extern "C" {
+#include <string.h>
+}
+
+#include <vector>
+
+namespace FastGlobalFileStatus {
+
+  namespace MountPointAttribute {
+
+    /**
+     *   Defines an append-only store of strings.
+     *
+     *   Strings are copied back to back into large blocks, so storing
+     *   a string costs no allocation of its own and all of them are
+     *   freed at once. A stored string stays at the same address until
+     *   the arena is cleared or destroyed. The class does no locking 
+     *   of its own.
+     */
+    class StringArena {
+        public:
+            explicit StringArena(size_t blkSize = 64 * 1024);
+            ~StringArena();
+
+            /**
+             *   Copies a string into the arena.
+             *
+             *   @param[in] s the string; it need not be NUL terminated.
+             *   @param[in] len the length of s.
+             *   @return the NUL terminated copy.
+             */
+            const char * store(const char *s, size_t len);
+
+            /**
+             *   Frees all stored strings.
+             */
+            void clear();
+
+            /**
+             *   Returns the number of bytes of the stored strings
+             *   including their terminators.
+             */
+            size_t bytesUsed() const { return used; }
+
+        private:
+            StringArena(const StringArena &o);
+            StringArena & operator=(const StringArena &rhs);
+
+            std::vector<char *> blocks;
+            char *cur;          /*!< free space of the last block */
+            size_t left;        /*!< bytes left at cur */
+            size_t blockSize;
+            size_t used;
+    };
+
+  } // MountPointAttribute namespace
+
+} // FastGlobalFileStatus namespace
+
+#endif // MOUNT_POINT_ATTR_ARENA_H
@@ -0,0 +1,164 @@
+/*
+ * -------------------------------------------------------------------------------- 
+ * Copyright (c) 2011, Lawrence Livermore National Security, LLC. Produced at
+ * the Lawrence Livermore National Laboratory. Written by Dong H. Ahn <ahn1@llnl.gov>. 
+ * LLNL-CODE-490173. All rights reserved.
+ * 
+ * This file is part of MountPointAttributes. For details, 
+ * see https://computing.llnl.gov/?set=resources&page=os_projects
+ * 
+ * Please also read LICENSE - Our Notice and GNU Lesser General Public License.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under 
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the terms and conditions of the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA 02111-1307 USA
+ * --------------------------------------------------------------------------------
+ *
+ * Update Log:
+ *        Oct 17 2026 agent: File created.
+ *
+ */
+
+#ifndef MOUNT_POINT_ATTR_CACHE_H
+#define MOUNT_POINT_ATTR_CACHE_H 1
+
+#include <list>
+#include <map>
+#include <utility>
+
+namespace FastGlobalFileStatus {
+
+  namespace MountPointAttribute {
+
+    /**
+     *   Defines a bounded map that evicts its least recently used 
+     *   entry when it is full. Keys are ordered so that all entries 
+     *   under a key prefix (e.g., a directory) can be invalidated at 
+     *   once. The class does no locking of its own.
+     */
+    template <typename K, typename V>
+    class LruCache {
+        public:
+            /**
+             *   ctor.
+             *
+             *   @param[in] cap the maximum number of entries; 0 disables 
+             *                  the cache.
+             */
+            explicit LruCache(size_t cap = 0) : capacity(cap) { }
+
+            /**
+             *   Changes the capacity, evicting entries as needed.
+             */
+            void setCapacity(size_t cap)
+            {
+                capacity = cap;
+                while (index.size() > capacity) {
+                    evict();
+                }
+            }
+
+            size_t getCapacity() const { return capacity; }
+
+            size_t size() const { return index.size(); }
+
+            /**
+             *   Looks up a key and marks it most recently used.
+             *
+             *   @return true if found; value is set to its value.
+             */
+            bool find(const K &key, V &value)
+            {
+                typename Index::iterator i = index.find(key);
+                if (i == index.end()) {
+                    return false;
+                }
+
+                lru.splice(lru.begin(), lru, i->second);
+                value = i->second->second;
+
+                return true;
+            }
+
+            /**
+             *   Inserts or updates a key as the most recently used entry.
+             */
+            void insert(const K &key, const V &value)
+            {
+                if (capacity == 0) {
+                    return;
+                }
+
+                typename Index::iterator i = index.find(key);
+                if (i != index.end()) {
+                    i->second->second = value;
+                    lru.splice(lru.begin(), lru, i->second);
+                    return;
+                }
+
+                if (index.size() >= capacity) {
+                    evict();
+                }
+
+                lru.push_front(std::make_pair(key, value));
+                index[key] = lru.begin();
+            }
+
+            void erase(const K &key)
+            {
+                typename Index::iterator i = index.find(key);
+                if (i != index.end()) {
+                    lru.erase(i->second);
+                    index.erase(i);
+                }
+            }
+
+            /**
+             *   Erases every entry whose key starts with prefix.
+             *   K must be a sequence type like std::string.
+             */
+            void erasePrefix(const K &prefix)
+            {
+                typename Index::iterator i = index.lower_bound(prefix);
+                while (i != index.end()
+                       && i->first.compare(0, prefix.size(), prefix) == 0) {
+                    lru.erase(i->second);
+                    index.erase(i++);
+                }
+            }
+
+            void clear()
+            {
+                lru.clear();
+                index.clear();
+            }
+
+        private:
+            typedef std::list<std::pair<K, V> > List;
+            typedef std::map<K, typename List::iterator> Index;
+
+            void evict()
+            {
+                index.erase(lru.back().first);
+                lru.pop_back();
+            }
+
+            List lru;     /*!< most recently used first */
+            Index index;
+            size_t capacity;
+    };
+
+  } // MountPointAttribute namespace
+
+} // FastGlobalFileStatus namespace
+
+#endif // MOUNT_POINT_ATTR_CACHE_H
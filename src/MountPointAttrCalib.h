@@ -0,0 +1,158 @@
+/*
+ * -------------------------------------------------------------------------------- 
+ * Copyright (c) 2011, Lawrence Livermore National Security, LLC. Produced at
+ * the Lawrence Livermore National Laboratory. Written by Dong H. Ahn <ahn1@llnl.gov>. 
+ * LLNL-CODE-490173. All rights reserved.
+ * 
+ * This file is part of MountPointAttributes. For details, 
+ * see https://computing.llnl.gov/?set=resources&page=os_projects
+ * 
+ * Please also read LICENSE - Our Notice and GNU Lesser General Public License.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under 
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the terms and conditions of the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA 02111-1307 USA
+ * --------------------------------------------------------------------------------
+ *
+ * Update Log:
+ *        Oct 17 2026 agent: File created.
+ *
+ */
+
+#ifndef MOUNT_POINT_ATTR_CALIB_H
+#define MOUNT_POINT_ATTR_CALIB_H 1
+
+extern "C" {
+#include <time.h>
+#include <string.h>
+}
+
+#include <map>
+#include <string>
+
+namespace FastGlobalFileStatus {
+
+  namespace MountPointAttribute {
+
+    /**
+     *   Streaming throughput that counts as one BASE_FS_SPEED in 
+     *   MountPointInfo::getSpeed of a calibrated mount point.
+     */
+    const double CALIB_SPEED_UNIT_MBPS = 100.0;
+
+    /**
+     *   Metadata operations per second that count as one 
+     *   BASE_FS_SCALABILITY in MountPointInfo::getScalability of 
+     *   a calibrated mount point.
+     */
+    const double CALIB_SCALABILITY_UNIT_OPS = 1000.0;
+
+
+    /**
+     *   Measured performance of a mount point. A field is 0 if 
+     *   it wasn't measured.
+     */
+    struct MountPerf {
+        double metaLatencyUs;  /*!< median latency of a metadata probe */
+        double readMBps;       /*!< streaming read throughput */
+        double writeMBps;      /*!< streaming write throughput */
+        time_t measured;       /*!< when the probes ran */
+    };
+
+
+    /**
+     *   Bounds of the probes of a calibration and where their results
+     *   are cached.
+     */
+    struct CalibrationOptions {
+        /**
+         *   Sets the defaults. cacheFile is $MPA_CALIBRATION_CACHE if 
+         *   set and $HOME/.mpattr_calibration otherwise.
+         */
+        CalibrationOptions();
+
+        unsigned metaProbes;    /*!< metadata probes per mount point */
+        unsigned maxOpsPerSec;  /*!< rate limit of metadata probes; 0 is none */
+        size_t ioBytes;         /*!< bytes written then read back; 0 skips */
+        double maxSeconds;      /*!< time budget per mount point */
+        std::string cacheFile;  /*!< empty disables the on-disk cache */
+        unsigned maxAge;        /*!< seconds a cached result is reused */
+        bool force;             /*!< probe even if a cached result is fresh */
+    };
+
+
+    /**
+     *   Probes the performance of the file system of a directory.
+     *
+     *   If the directory is writable, a probe file is created in it:
+     *   ioBytes are written and synced, dropped from the page cache 
+     *   and read back, and each metadata probe creates, stats and 
+     *   removes a file, which no client cache can answer. Otherwise 
+     *   only metadata probes are run, each a stat and an open of the 
+     *   directory. Probes stop once maxSeconds have passed.
+     *
+     *   @param[in] dir a directory on the file system.
+     *   @param[in] opts bounds of the probes.
+     *   @param[out] perf the measurements.
+     *   @return true if any probe succeeded.
+     */
+    bool MPA_probeMountPerf(const char *dir, 
+                           const CalibrationOptions &opts,
+                           MountPerf &perf);
+
+
+    /**
+     *   Defines the on-disk cache of calibration results. 
+     *
+     *   Each line holds a key, e.g., a mount point's source, type and
+     *   options, with blanks and backslashes escaped in octal, then 
+     *   the measurement time, latency and throughputs. The file is 
+     *   replaced atomically on save and entries saved meanwhile by 
+     *   other processes are kept.
+     */
+    class MountPerfCache {
+        public:
+            /**
+             *   Adds the entries of a cache file. 
+             *
+             *   @return false if the file can't be read.
+             */
+            bool load(const std::string &file);
+
+            /**
+             *   Merges the entries into a cache file.
+             *
+             *   @return false if the file can't be written.
+             */
+            bool save(const std::string &file) const;
+
+            /**
+             *   Finds the result of a key measured no more than maxAge
+             *   seconds ago.
+             */
+            bool find(const std::string &key, 
+                      unsigned maxAge, 
+                      MountPerf &perf) const;
+
+            void insert(const std::string &key, const MountPerf &perf);
+
+            size_t size() const { return entries.size(); }
+
+        private:
+            std::map<std::string, MountPerf> entries;
+    };
+
+  } // MountPointAttribute namespace
+
+} // FastGlobalFileStatus namespace
+
+#endif // MOUNT_POINT_ATTR_CALIB_H
@@ -0,0 +1,124 @@
+/*
+ * -------------------------------------------------------------------------------- 
+ * Copyright (c) 2011, Lawrence Livermore National Security, LLC. Produced at
+ * the Lawrence Livermore National Laboratory. Written by Dong H. Ahn <ahn1@llnl.gov>. 
+ * LLNL-CODE-490173. All rights reserved.
+ * 
+ * This file is part of MountPointAttributes. For details, 
+ * see https://computing.llnl.gov/?set=resources&page=os_projects
+ * 
+ * Please also read LICENSE - Our Notice and GNU Lesser General Public License.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under 
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the terms and conditions of the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA 02111-1307 USA
+ * --------------------------------------------------------------------------------
+ *
+ * Update Log:
+ *        Oct 17 2026 agent: File created.
+ *
+ */
+
+#ifndef MOUNT_POINT_ATTR_HASH_H
+#define MOUNT_POINT_ATTR_HASH_H 1
+
+extern "C" {
+#include <stdint.h>
+#include <string.h>
+}
+
+#include <string>
+
+namespace FastGlobalFileStatus {
+
+  namespace MountPointAttribute {
+
+    /**
+     *   Defines a 128-bit digest of a URI.
+     *
+     *   Digests are stable across nodes and runs: the same URI string
+     *   yields the same digest regardless of byte order or word size, 
+     *   so nodes can exchange and compare digests in place of URI 
+     *   strings.
+     */
+    struct UriHash {
+        uint64_t hi;
+        uint64_t lo;
+
+        bool operator==(const UriHash &rhs) const 
+            { return hi == rhs.hi && lo == rhs.lo; }
+        bool operator!=(const UriHash &rhs) const 
+            { return !(*this == rhs); }
+        bool operator<(const UriHash &rhs) const 
+            { return hi < rhs.hi || (hi == rhs.hi && lo < rhs.lo); }
+
+        /**
+         *   Stores the digest as 16 bytes, most significant first.
+         *
+         *   @param[out] buf a buffer of at least 16 bytes.
+         */
+        void getBytes(unsigned char *buf) const;
+
+        /**
+         *   Returns the digest as 32 lower case hex digits.
+         */
+        std::string toString() const;
+    };
+
+
+    /**
+     *   Computes UriHash digests incrementally (MurmurHash3 x64_128).
+     *
+     *   The state can be copied at any point, so the state after the
+     *   URI prefix of a mount point is computed once and each file of 
+     *   that mount point only hashes its own path. The digest doesn't
+     *   depend on how the input is split across update calls.
+     */
+    class UriHasher {
+        public:
+            UriHasher();
+
+            /**
+             *   Restarts the digest.
+             */
+            void reset();
+
+            /**
+             *   Appends bytes to the hashed input.
+             */
+            void update(const char *data, size_t len);
+
+            void update(const std::string &s) { update(s.data(), s.size()); }
+
+            /**
+             *   Computes the digest of the input so far. The state is 
+             *   left untouched so that more input can follow.
+             *
+             *   @param[out] hash the digest.
+             */
+            void finish(UriHash &hash) const;
+
+        private:
+            void mixBlock(const unsigned char *block);
+
+            uint64_t h1;
+            uint64_t h2;
+            uint64_t total;             /*!< bytes hashed so far */
+            unsigned char tail[16];     /*!< bytes of an incomplete block */
+            size_t tailLen;
+    };
+
+  } // MountPointAttribute namespace
+
+} // FastGlobalFileStatus namespace
+
+#endif // MOUNT_POINT_ATTR_HASH_H
@@ -0,0 +1,98 @@
+/*
+ * -------------------------------------------------------------------------------- 
+ * Copyright (c) 2011, Lawrence Livermore National Security, LLC. Produced at
+ * the Lawrence Livermore National Laboratory. Written by Dong H. Ahn <ahn1@llnl.gov>. 
+ * LLNL-CODE-490173. All rights reserved.
+ * 
+ * This file is part of MountPointAttributes. For details, 
+ * see https://computing.llnl.gov/?set=resources&page=os_projects
+ * 
+ * Please also read LICENSE - Our Notice and GNU Lesser General Public License.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under 
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the terms and conditions of the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA 02111-1307 USA
+ * --------------------------------------------------------------------------------
+ *
+ * Update Log:
+ *        Oct 17 2026 agent: Dropped the node name from the image.
+ *        Oct 17 2026 agent: File created.
+ *
+ */
+
+#ifndef MOUNT_POINT_ATTR_IMAGE_H
+#define MOUNT_POINT_ATTR_IMAGE_H 1
+
+extern "C" {
+#include <time.h>
+}
+
+#include <map>
+#include <string>
+#include "MountPointAttr.h"
+
+namespace FastGlobalFileStatus {
+
+  namespace MountPointAttribute {
+
+    /**
+     *   Computes a digest of the mount table of the calling process's
+     *   mount namespace as the kernel reports it. Any mount or unmount
+     *   changes it. This reads the mount point file but doesn't parse 
+     *   it.
+     *
+     *   @param[out] state the digest.
+     *   @return false if no mount point file can be read.
+     */
+    bool MPA_mountStateDigest(UriHash &state);
+
+    /**
+     *   Writes a parsed snapshot as a read-only image to path. 
+     *
+     *   The image holds no pointers: the entries, the URI records, 
+     *   the trie and the device index are arrays that refer to each 
+     *   other and to their strings by offsets, so it can be mapped at 
+     *   any address and queried in place. It is written to a temporary
+     *   file and renamed into place, so readers see either the old or 
+     *   the new image. The URI records are left out unless the names 
+     *   of file servers come from $MPA_SERVER_MAP alone.
+     *
+     *   @param[in] state the MPA_mountStateDigest taken before snap 
+     *                    was parsed.
+     *   @return false if the image can't be written.
+     */
+    bool MPA_writeTableImage(const std::string &path,
+                             const MountTableSnapshot &snap,
+                             const UriHash &state);
+
+    /**
+     *   Maps the image at path as a snapshot. The image must be owned 
+     *   by the caller's user, not writable by others, no older than 
+     *   maxAge seconds, intact and written under the given mount 
+     *   state. The snapshot keeps the mapping: its trie and device 
+     *   index are read from it. The mount table itself, which the 
+     *   snapshot hands out as MyMntEnt objects, and the URI records,
+     *   unless the caller names file servers differently, are copied.
+     *
+     *   @param[in] state the caller's MPA_mountStateDigest.
+     *   @return a snapshot with one reference; NULL if the image 
+     *           can't be used.
+     */
+    MountTableSnapshot *MPA_readTableImage(const std::string &path,
+                                           unsigned maxAge,
+                                           const UriHash &state);
+
+  } // MountPointAttribute namespace
+
+} // FastGlobalFileStatus namespace
+
+#endif // MOUNT_POINT_ATTR_IMAGE_H
@@ -0,0 +1,167 @@
+/*
+ * -------------------------------------------------------------------------------- 
+ * Copyright (c) 2011, Lawrence Livermore National Security, LLC. Produced at
+ * the Lawrence Livermore National Laboratory. Written by Dong H. Ahn <ahn1@llnl.gov>. 
+ * LLNL-CODE-490173. All rights reserved.
+ * 
+ * This file is part of MountPointAttributes. For details, 
+ * see https://computing.llnl.gov/?set=resources&page=os_projects
+ * 
+ * Please also read LICENSE - Our Notice and GNU Lesser General Public License.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under 
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the terms and conditions of the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA 02111-1307 USA
+ * --------------------------------------------------------------------------------
+ *
+ * Update Log:
+ *        Oct 17 2026 agent: lookup can report its cost.
+ *        Oct 17 2026 agent: File created.
+ *
+ */
+
+#ifndef MOUNT_POINT_ATTR_INDEX_H
+#define MOUNT_POINT_ATTR_INDEX_H 1
+
+extern "C" {
+#include <string.h>
+}
+
+#include <string>
+#include <vector>
+
+namespace FastGlobalFileStatus {
+
+  namespace MountPointAttribute {
+
+    /**
+     *   Work done by MntPntTrie::lookup, for statistics.
+     */
+    struct MntPntTrieCost {
+        unsigned long long comps;   /*!< path components walked */
+        unsigned long long probes;  /*!< trie nodes compared */
+    };
+
+
+    /**
+     *   Defines a longest-prefix-match index over mount point directories.
+     *
+     *   The index is a trie keyed on path components ("/", "usr", "lib64"...)
+     *   that is built once when the mount point table is parsed. All nodes
+     *   and component names are kept in two flat arrays and refer to each 
+     *   other through offsets, and the children of a node are stored 
+     *   contiguously in sorted order. A lookup is therefore a single 
+     *   forward scan of the path with a binary search per component,
+     *   and it neither allocates memory nor modifies the path.
+     */
+    class MntPntTrie {
+        public:
+            MntPntTrie();
+            ~MntPntTrie();
+
+            /**
+             *   Rebuilds the index.
+             *
+             *   @param[in] dirs mount point directories. The position of 
+             *                   each directory is the value that lookup
+             *                   returns for the paths it covers.
+             */
+            void build(const std::vector<const char *> &dirs);
+
+            /**
+             *   A node of the trie. Nodes refer to each other and to 
+             *   their component names by offsets only, so an array of 
+             *   them can be stored and used at any address.
+             */
+            struct Node {
+                unsigned compOff;     /*!< offset of the component into pool */
+                unsigned compLen;     /*!< length of the component */
+                unsigned firstChild;  /*!< index of the first child node */
+                unsigned numChildren; /*!< number of contiguous children */ 
+                int entry;            /*!< directory position; -1 if none */
+            };
+
+            /**
+             *   Makes the index use arrays that a build stored elsewhere,
+             *   e.g., in a mapped file, instead of its own. They must 
+             *   outlive the index or the next build, attach or clear.
+             *
+             *   @param[in] nodes the node array.
+             *   @param[in] numNodes the number of nodes.
+             *   @param[in] pool the component names.
+             *   @param[in] poolSize the bytes of pool.
+             *   @param[in] numDirs the number of directories the index
+             *                      was built from.
+             *   @return false if the arrays don't form a valid index,
+             *           which leaves the index empty.
+             */
+            bool attach(const Node *nodes, 
+                        size_t numNodes, 
+                        const char *pool, 
+                        size_t poolSize,
+                        size_t numDirs);
+
+            /**
+             *   Empties the index.
+             */
+            void clear();
+
+            /**
+             *   Finds the deepest indexed directory that is a prefix
+             *   of the given path in terms of path components. Empty
+             *   components, which result from "//" or a trailing '/', 
+             *   are skipped.
+             *
+             *   @param[in] path an absolute path.
+             *   @param[out] cost if not NULL, the work the lookup did 
+             *                    is added to it.
+             *   @return the position of the matching directory given 
+             *           to build; -1 if none matches. 
+             */
+            int lookup(const char *path, MntPntTrieCost *cost = NULL) const;
+
+            /**
+             *   Returns the number of trie nodes.
+             */
+            size_t size() const { return numNodes; }
+
+            /**
+             *   Returns the arrays in use, to be stored for attach.
+             */
+            const Node *nodeArray() const { return nodeBase; }
+            const char *poolArray() const { return poolBase; }
+            size_t poolSize() const { return poolBytes; }
+
+        private:
+            int findChild(const Node &parent, 
+                          const char *comp, 
+                          size_t len,
+                          unsigned long long *probes) const;
+
+            std::vector<Node> nodes;
+            std::vector<char> pool;
+
+            //
+            // The arrays lookup reads: nodes and pool after a build, 
+            // the caller's after attach.
+            //
+            const Node *nodeBase;
+            size_t numNodes;
+            const char *poolBase;
+            size_t poolBytes;
+    };
+
+  } // MountPointAttribute namespace
+
+} // FastGlobalFileStatus namespace
+
+#endif // MOUNT_POINT_ATTR_INDEX_H
@@ -0,0 +1,130 @@
+/*
+ * -------------------------------------------------------------------------------- 
+ * Copyright (c) 2011, Lawrence Livermore National Security, LLC. Produced at
+ * the Lawrence Livermore National Laboratory. Written by Dong H. Ahn <ahn1@llnl.gov>. 
+ * LLNL-CODE-490173. All rights reserved.
+ * 
+ * This file is part of MountPointAttributes. For details, 
+ * see https://computing.llnl.gov/?set=resources&page=os_projects
+ * 
+ * Please also read LICENSE - Our Notice and GNU Lesser General Public License.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under 
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the terms and conditions of the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA 02111-1307 USA
+ * --------------------------------------------------------------------------------
+ *
+ * Update Log:
+ *        Oct 17 2026 agent: Added load with format detection.
+ *        Oct 17 2026 agent: File created.
+ *
+ */
+
+#ifndef MOUNT_POINT_ATTR_PARSER_H
+#define MOUNT_POINT_ATTR_PARSER_H 1
+
+extern "C" {
+#include <stddef.h>
+}
+
+#include <vector>
+
+namespace FastGlobalFileStatus {
+
+  namespace MountPointAttribute {
+
+    /**
+     *   Defines the fields of a line of a mount point file. All 
+     *   strings point into the buffer of the MountTableParser that 
+     *   produced the line and remain valid until it loads again. 
+     *   Octal escapes (e.g., \040 for a blank) are already decoded.
+     */
+    struct MountTableLine {
+        char *fsname;      /*!< device or server for filesystem */
+        char *dir;         /*!< directory mounted on */
+        char *type;        /*!< type of filesystem */
+        char *opts;        /*!< mount options */
+        char *superOpts;   /*!< super block options; mountinfo only */
+        char *root;        /*!< root of the mount within the fs; mountinfo only */
+        char *optional;    /*!< propagation fields; mountinfo only */
+        int freq;          /*!< dump frequency; mounts format only */
+        int passno;        /*!< fsck pass number; mounts format only */
+        int mntId;         /*!< mount ID; -1 for the mounts format */
+        int parentId;      /*!< parent mount ID; -1 for the mounts format */
+        unsigned devMajor; /*!< st_dev major of the files; mountinfo only */
+        unsigned devMinor; /*!< st_dev minor of the files; mountinfo only */
+    };
+
+
+    /**
+     *   Defines a parser for /proc/mounts, /etc/mtab and 
+     *   /proc/self/mountinfo formatted files.
+     *
+     *   The whole file is read into a single buffer with a few 
+     *   large reads and lines are tokenized in place: no memory is 
+     *   allocated per line, and lines of any length are handled. 
+     */
+    class MountTableParser {
+        public:
+            MountTableParser();
+            ~MountTableParser();
+
+            /**
+             *   Reads a mount point file.
+             *
+             *   @param[in] file the path of the file.
+             *   @param[in] mountInfo true if the file is in the 
+             *                        /proc/self/mountinfo format.
+             *   @return true on success; false if the file can't be read.
+             */
+            bool load(const char *file, bool mountInfo);
+
+            /**
+             *   Reads a mount point file of either format. The format is
+             *   told from the first line: mountinfo lines start with two
+             *   numeric mount IDs.
+             *
+             *   @param[in] file the path of the file.
+             *   @return true on success; false if the file can't be read.
+             */
+            bool load(const char *file);
+
+            /**
+             *   Returns the next line of the file loaded. Malformed 
+             *   lines are skipped and counted.
+             *
+             *   @param[out] line the fields of the line.
+             *   @return true if a line is returned; false at the end.
+             */
+            bool next(MountTableLine &line);
+
+            /**
+             *   Returns the number of malformed lines skipped so far.
+             */
+            size_t numMalformed() const { return malformed; }
+
+        private:
+            bool parseMountsLine(char *p, MountTableLine &line);
+            bool parseMountInfoLine(char *p, MountTableLine &line);
+
+            std::vector<char> buf;
+            size_t len;         /*!< bytes of the file in buf */
+            size_t pos;         /*!< start of the next line */
+            size_t malformed;
+            bool mountInfo;
+    };
+
+  } // MountPointAttribute namespace
+
+} // FastGlobalFileStatus namespace
+
+#endif // MOUNT_POINT_ATTR_PARSER_H
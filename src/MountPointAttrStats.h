@@ -0,0 +1,143 @@
+/*
+ * -------------------------------------------------------------------------------- 
+ * Copyright (c) 2011, Lawrence Livermore National Security, LLC. Produced at
+ * the Lawrence Livermore National Laboratory. Written by Dong H. Ahn <ahn1@llnl.gov>. 
+ * LLNL-CODE-490173. All rights reserved.
+ * 
+ * This file is part of MountPointAttributes. For details, 
+ * see https://computing.llnl.gov/?set=resources&page=os_projects
+ * 
+ * Please also read LICENSE - Our Notice and GNU Lesser General Public License.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under 
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the terms and conditions of the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA 02111-1307 USA
+ * --------------------------------------------------------------------------------
+ *
+ * Update Log:
+ *        Oct 17 2026 agent: Added the link cache counters.
+ *        Oct 17 2026 agent: File created.
+ *
+ */
+
+#ifndef MOUNT_POINT_ATTR_STATS_H
+#define MOUNT_POINT_ATTR_STATS_H 1
+
+extern "C" {
+#include <stdint.h>
+#include <stdio.h>
+}
+
+namespace FastGlobalFileStatus {
+
+  namespace MountPointAttribute {
+
+    /**
+     *   Lists the calls whose count and latency are recorded.
+     */
+    enum MPAStatsCall {
+        stat_getMntPntInfo = 0,
+        stat_getMntPntInfo2,
+        stat_isRemoteFileSystem,
+        stat_getFileUriInfo,
+        stat_getFileUriInfoByDev,
+        stat_parse,
+        stat_refresh,
+        stat_num_calls
+    };
+
+
+    /**
+     *   Number of buckets of each histogram. Latency bucket i counts
+     *   calls that took [2^i, 2^(i+1)) nanoseconds; depth bucket i 
+     *   counts lookups that walked i path components. The last bucket 
+     *   of either also takes everything above it.
+     */
+    const int MPA_STATS_HIST_SIZE = 32;
+
+
+    /**
+     *   Counters of one call.
+     */
+    struct MPACallStats {
+        uint64_t calls;
+        uint64_t errors;    /*!< calls that failed, e.g., no mount point */
+        uint64_t totalNs;
+        uint64_t maxNs;
+        uint64_t latencyHist[MPA_STATS_HIST_SIZE];
+    };
+
+
+    /**
+     *   Counters of the library as a whole.
+     */
+    struct MPAStats {
+        MPACallStats call[stat_num_calls];
+
+        uint64_t lookups;           /*!< mount point lookups by path */
+        uint64_t lookupMisses;      /*!< lookups that found no mount point */
+        uint64_t walkComps;         /*!< path components walked */
+        uint64_t walkProbes;        /*!< trie nodes compared */
+        uint64_t walkDepthHist[MPA_STATS_HIST_SIZE];
+        uint64_t unionAccessCalls;  /*!< access() calls on union branches */
+        uint64_t unionCacheHits;    /*!< branch probes answered by the cache */
+        uint64_t parsedEntries;     /*!< mount table entries parsed */
+        uint64_t linkReads;         /*!< readlink calls of resolveLinks */
+        uint64_t linkCacheHits;     /*!< directories answered by the link cache */
+        uint64_t dirMemoHits;       /*!< batch lookups answered by a directory memo */
+    };
+
+
+    /**
+     *   Turns the counters on or off. They are off by default unless
+     *   MPA_STATS_DUMP is set in the environment, in which case they 
+     *   are on and are printed at exit: to stderr if the value is 
+     *   "1" or "stderr", to stdout if it is "stdout" and appended to 
+     *   the file it names otherwise. 
+     *
+     *   While the counters are off, an instrumented call costs a test 
+     *   of a flag. Each thread counts into its own block, so threads 
+     *   never contend over a counter.
+     */
+    void MPA_enableStats(bool on);
+
+    bool MPA_statsEnabled();
+
+    /**
+     *   Sums the counters of all threads, including those that 
+     *   have exited.
+     *
+     *   @param[out] stats the counters.
+     */
+    void MPA_getStats(MPAStats &stats);
+
+    /**
+     *   Zeros the counters. Calls running concurrently may or may not
+     *   be counted.
+     */
+    void MPA_resetStats();
+
+    /**
+     *   Prints the counters in a human-readable form.
+     */
+    void MPA_printStats(FILE *fptr);
+
+    /**
+     *   Returns the name of an instrumented call.
+     */
+    const char * MPA_statsCallName(MPAStatsCall c);
+
+  } // MountPointAttribute namespace
+
+} // FastGlobalFileStatus namespace
+
+#endif // MOUNT_POINT_ATTR_STATS_H
@@ -0,0 +1,108 @@
+/*
+ * -------------------------------------------------------------------------------- 
+ * Copyright (c) 2011, Lawrence Livermore National Security, LLC. Produced at
+ * the Lawrence Livermore National Laboratory. Written by Dong H. Ahn <ahn1@llnl.gov>. 
+ * LLNL-CODE-490173. All rights reserved.
+ * 
+ * This file is part of MountPointAttributes. For details, 
+ * see https://computing.llnl.gov/?set=resources&page=os_projects
+ * 
+ * Please also read LICENSE - Our Notice and GNU Lesser General Public License.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under 
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the terms and conditions of the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA 02111-1307 USA
+ * --------------------------------------------------------------------------------
+ *
+ * Update Log:
+ *        Oct 17 2026 agent: File created.
+ *
+ */
+
+#ifndef MOUNT_POINT_ATTR_STATS_IMPL_H
+#define MOUNT_POINT_ATTR_STATS_IMPL_H 1
+
+extern "C" {
+#include <stdint.h>
+}
+
+#include "MountPointAttrStats.h"
+#include "MountPointAttrIndex.h"
+
+namespace FastGlobalFileStatus {
+
+  namespace MountPointAttribute {
+
+    /**
+     *   Counters of one thread. Blocks stay on a global list while
+     *   their thread lives; at thread exit a block is folded into 
+     *   the retired totals and freed.
+     */
+    struct StatsBlock {
+        MPAStats stats;
+        StatsBlock *next;
+    };
+
+    extern volatile bool statsOn;
+    extern __thread StatsBlock *statsTls;
+
+    StatsBlock * statsNewBlock();
+    uint64_t statsNowNs();
+    void statsRecordCall(MPAStatsCall c, uint64_t startNs, bool failed);
+
+    inline MPAStats &
+    statsLocal()
+    {
+        StatsBlock *b = statsTls;
+        return (b)? b->stats : statsNewBlock()->stats;
+    }
+
+    inline void
+    statsRecordLookup(const MntPntTrieCost &cost, bool miss)
+    {
+        MPAStats &s = statsLocal();
+        s.lookups++;
+        s.walkComps += cost.comps;
+        s.walkProbes += cost.probes;
+        s.walkDepthHist[(cost.comps < (unsigned) MPA_STATS_HIST_SIZE)?
+                        cost.comps : MPA_STATS_HIST_SIZE - 1]++;
+        if (miss) {
+            s.lookupMisses++;
+        }
+    }
+
+
+    /**
+     *   Times an instrumented call from construction to done. 
+     *   Nothing is read or recorded if the counters were off when 
+     *   the call started.
+     */
+    class StatsTimer {
+        public:
+            explicit StatsTimer(MPAStatsCall c) 
+                : call(c), on(statsOn), startNs(0) 
+                { if (on) startNs = statsNowNs(); }
+
+            void done(bool failed) 
+                { if (on) statsRecordCall(call, startNs, failed); }
+
+        private:
+            MPAStatsCall call;
+            bool on;
+            uint64_t startNs;
+    };
+
+  } // MountPointAttribute namespace
+
+} // FastGlobalFileStatus namespace
+
+#endif // MOUNT_POINT_ATTR_STATS_IMPL_H
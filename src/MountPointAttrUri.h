@@ -24,6 +24,9 @@
  * --------------------------------------------------------------------------------
  *
  * Update Log:
+ *        Oct 17 2026 agent: Added the file server name map and resolver.
+ *        Oct 17 2026 agent: Added MPA_setLocalNodeName.
+ *        Oct 17 2026 agent: Added UriScheme::getUriPrefix.
  *        May 23 2011 DHA: Moved internal data structure from 
  *                         MountPointAttr.h.
  *
@@ -60,11 +63,25 @@ namespace FastGlobalFileStatus {
      */
     class UriScheme {
         public:
+            virtual ~UriScheme();
+
+            /**
+             *   Composes the URI of a file.
+             */
             virtual void getUri(const std::string &hostAddr,
                                 const std::string &exportDir,
                                 const std::string &pathFromExportDir,
                                 const std::string &mountPoint,
-                                std::string &uri) const = 0;
+                                std::string &uri) const;
+
+            /**
+             *   Composes the part of the URI that precedes pathFromExportDir.
+             *   This depends only on the mount point, so it can be 
+             *   computed once per mount point.
+             */
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const = 0;
     };
 
 
@@ -74,11 +91,9 @@ namespace FastGlobalFileStatus {
      */
     class NfsUriScheme : public UriScheme {
         public:
-            virtual void getUri(const std::string &hostAddr,
-                                const std::string &exportDir,
-                                const std::string &pathFromExportDir,
-                                const std::string &mountPoint,
-                                std::string &uri) const;
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const;
 
     };
 
@@ -89,11 +104,9 @@ namespace FastGlobalFileStatus {
      */
     class LustreUriScheme : public UriScheme {
         public:
-            virtual void getUri(const std::string &hostAddr,
-                                const std::string &exportDir,
-                                const std::string &pathFromExportDir,
-                                const std::string &mountPoint,
-                                std::string &uri) const;
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const;
     };
 
 
@@ -103,11 +116,9 @@ namespace FastGlobalFileStatus {
      */
     class GpfsUriScheme : public UriScheme {
         public:
-            virtual void getUri(const std::string &hostAddr,
-                                const std::string &exportDir,
-                                const std::string &pathFromExportDir,
-                                const std::string &mountPoint,
-                                std::string &uri) const;
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const;
     };
 
 
@@ -116,11 +127,9 @@ namespace FastGlobalFileStatus {
      */
     class PanfsUriScheme : public UriScheme {
         public:
-            virtual void getUri(const std::string &hostAddr,
-                                const std::string &exportDir,
-                                const std::string &pathFromExportDir,
-                                const std::string &mountPoint,
-                                std::string &uri) const;
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const;
     };
 
 
@@ -129,11 +138,9 @@ namespace FastGlobalFileStatus {
      */
     class PlfsUriScheme : public UriScheme {
         public:
-            virtual void getUri(const std::string &hostAddr,
-                                const std::string &exportDir,
-                                const std::string &pathFromExportDir,
-                                const std::string &mountPoint,
-                                std::string &uri) const;
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const;
     };
 
 
@@ -142,11 +149,9 @@ namespace FastGlobalFileStatus {
      */
     class DvsUriScheme : public UriScheme {
         public:
-            virtual void getUri(const std::string &hostAddr,
-                                const std::string &exportDir,
-                                const std::string &pathFromExportDir,
-                                const std::string &mountPoint,
-                                std::string &uri) const;
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const;
     };
 
 
@@ -155,11 +160,9 @@ namespace FastGlobalFileStatus {
      */
     class CifsUriScheme : public UriScheme {
         public:
-            virtual void getUri(const std::string &hostAddr,
-                                const std::string &exportDir,
-                                const std::string &pathFromExportDir,
-                                const std::string &mountPoint,
-                                std::string &uri) const;
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const;
     };
 
 
@@ -168,11 +171,9 @@ namespace FastGlobalFileStatus {
      */
     class SmbUriScheme : public UriScheme {
         public:
-            virtual void getUri(const std::string &hostAddr,
-                                const std::string &exportDir,
-                                const std::string &pathFromExportDir,
-                                const std::string &mountPoint,
-                                std::string &uri) const;
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const;
     };
 
 
@@ -182,11 +183,9 @@ namespace FastGlobalFileStatus {
      */
     class LocalUriScheme : public UriScheme {
         public:
-            virtual void getUri(const std::string &hostAddr,
-                                const std::string &exportDir,
-                                const std::string &pathFromExportDir,
-                                const std::string &mountPoint,
-                                std::string &uri) const;
+            virtual void getUriPrefix(const std::string &hostAddr,
+                                      const std::string &exportDir,
+                                      std::string &prefix) const;
 
     };
 
@@ -211,9 +210,94 @@ namespace FastGlobalFileStatus {
 
     /**
      *   Wraps around gethostname to deal with some odd systems. 
+     *
+     *   The name is resolved on the first call or the first local URI,
+     *   never at parse time: MPA_setLocalNodeName, $MPA_LOCAL_FQDN, 
+     *   the per-node cache file ($MPA_NODE_NAME_CACHE or 
+     *   /dev/shm/mpattr-<uid>.fqdn), the canonical name of 
+     *   gethostname from getaddrinfo, and gethostname itself are 
+     *   tried in that order. A name found by getaddrinfo is saved in
+     *   the cache file for the other processes of the node.
+     *
+     *   @return 0 on success; -1 if no name is available.
      */
     int MPA_getLocalNodeName(char *name, size_t len);
 
+
+    /**
+     *   Sets the local node name, e.g., an FQDN the caller already 
+     *   knows, so that nothing is resolved. NULL reverts to resolution.
+     *   Takes effect for the URIs that follow; FileUriInfo objects 
+     *   already filled keep the old name.
+     */
+    void MPA_setLocalNodeName(const char *fqdn);
+
+
+    /**
+     *   Bounds how long the getaddrinfo of the local node name is 
+     *   waited for, 2000 ms by default. Once it times out, 
+     *   gethostname is used as is. 0 skips getaddrinfo; a negative 
+     *   value waits as long as it takes.
+     */
+    void MPA_setNodeNameTimeout(int ms);
+
+
+    /**
+     *   Maps the file server name of a mount source, e.g., dip-nfs 
+     *   or 10.1.1.5, to its canonical name. It is called without 
+     *   any lock of the library held and may be called by several 
+     *   threads at once, even for the same name.
+     *
+     *   @param[in] host the name as it appears in the mount source.
+     *   @param[out] canon the canonical name.
+     *   @param[in] arg as given to MPA_setServerResolver.
+     *   @return true if canon was set.
+     */
+    typedef bool (*MPAServerResolver)(const std::string &host, 
+                                      std::string &canon, 
+                                      void *arg);
+
+
+    /**
+     *   Adds the entries of a server map, in the format of /etc/hosts:
+     *   an address, the canonical name and any aliases per line. Each 
+     *   name on a line, case-insensitively, and the address map to the
+     *   canonical name. $MPA_SERVER_MAP is loaded on first use. 
+     *   The map is consulted before the resolver, so canonical names 
+     *   are available offline.
+     *
+     *   Names are canonicalized once per mount point when a table is 
+     *   parsed, so that two nodes that mount an export through 
+     *   different aliases build identical URIs. Answers are cached for
+     *   the process; changes of the map or the resolver take effect 
+     *   for the tables parsed afterwards.
+     *
+     *   @param[in] file the map; NULL drops the loaded entries.
+     *   @return the number of names loaded; -1 if file can't be read.
+     */
+    int MPA_loadServerMap(const char *file);
+
+
+    /**
+     *   Sets the resolver of the file server names that the server 
+     *   map doesn't cover. There is none by default, so parsing never
+     *   goes to NSS unless asked to. 
+     *
+     *   @param[in] fn the resolver; NULL keeps names as they are.
+     *   @param[in] arg passed to fn.
+     */
+    void MPA_setServerResolver(MPAServerResolver fn, void *arg);
+
+
+    /**
+     *   A resolver for MPA_setServerResolver: the canonical name from
+     *   getaddrinfo, or the name of the PTR record of an address, 
+     *   within the timeout of MPA_setNodeNameTimeout. arg is unused.
+     */
+    bool MPA_resolveServerByName(const std::string &host, 
+                                 std::string &canon, 
+                                 void *arg);
+
   } // MountPointAttribute namespace
 
 } // FastGlobalFileStatus namespace